@@ -0,0 +1,121 @@
+#ifndef STATS_HPP_
+#define STATS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace moenis {
+namespace stats {
+
+enum class Counter : std::size_t {
+  CAMERA_RAYS,
+  SHADOW_RAYS,
+  INDIRECT_RAYS,
+  BVH_NODES_VISITED,
+  TRIANGLE_TESTS,
+  SHADING_CALLS,
+  SAMPLES,
+  PIXELS,
+  ALLOCATED_BYTES,
+  COUNT
+};
+
+enum class Phase : std::size_t {
+  SCENE_LOAD,
+  BVH_BUILD,
+  RENDER,
+  OUTPUT,
+  COUNT
+};
+
+constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::COUNT);
+constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(Phase::COUNT);
+
+const char* name(Counter counter);
+const char* name(Phase phase);
+
+// Counters owned by a single thread. Only the owning thread writes, so an
+// increment is a relaxed load/store pair rather than a locked read-modify-write;
+// the atomics only exist so that merge() may read them while workers run. No
+// other thread ever writes a block, which is why there is no reset. Each block
+// sits on its own cache line to keep threads from false sharing.
+struct alignas(64) ThreadStats {
+  std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counters{};
+  std::array<std::atomic<std::uint64_t>, PHASE_COUNT> phase_ns{};
+};
+
+// Sum of every thread's counters, produced by merge().
+struct Report {
+  std::array<std::uint64_t, COUNTER_COUNT> counters{};
+  std::array<std::uint64_t, PHASE_COUNT> phase_ns{};
+
+  std::uint64_t operator[](Counter counter) const {
+    return counters[static_cast<std::size_t>(counter)];
+  }
+  std::uint64_t operator[](Phase phase) const {
+    return phase_ns[static_cast<std::size_t>(phase)];
+  }
+};
+
+// Returns the calling thread's block, registering it on first use. Blocks are
+// owned by a global registry so their counts outlive the thread.
+ThreadStats& local();
+
+Report merge();
+// Writes the report as JSON. Phase times are integral nanoseconds summed over
+// threads, and "stats_enabled" is false when built without MOENIS_ENABLE_STATS.
+void write_json(std::ostream& out, const Report& report);
+
+inline void add(Counter counter, std::uint64_t n = 1) {
+#ifdef MOENIS_ENABLE_STATS
+  static thread_local ThreadStats& block = local();
+  std::atomic<std::uint64_t>& value =
+      block.counters[static_cast<std::size_t>(counter)];
+  value.store(value.load(std::memory_order_relaxed) + n,
+              std::memory_order_relaxed);
+#else
+  static_cast<void>(counter);
+  static_cast<void>(n);
+#endif
+}
+
+inline void add(Phase phase, std::uint64_t ns) {
+#ifdef MOENIS_ENABLE_STATS
+  static thread_local ThreadStats& block = local();
+  std::atomic<std::uint64_t>& value =
+      block.phase_ns[static_cast<std::size_t>(phase)];
+  value.store(value.load(std::memory_order_relaxed) + ns,
+              std::memory_order_relaxed);
+#else
+  static_cast<void>(phase);
+  static_cast<void>(ns);
+#endif
+}
+
+// Accumulates the wall time of its scope into a phase of the calling thread.
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(Phase phase)
+      : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedPhase() {
+    add(phase_, static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start_)
+                        .count()));
+  }
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+ private:
+  Phase phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace stats
+}  // namespace moenis
+
+#endif  // STATS_HPP_
@@ -1 +1,36 @@
-int main() { return 0; }
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "stats.hpp"
+
+int main(int argc, char* argv[]) {
+  const char* stats_path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--stats") == 0) {
+      if (i + 1 >= argc) {
+        std::cerr << "Moenis: --stats requires a file path\n";
+        return 1;
+      }
+      stats_path = argv[++i];
+    } else {
+      std::cerr << "Moenis: unknown argument '" << argv[i] << "'\n";
+      return 1;
+    }
+  }
+  if (stats_path != nullptr) {
+#ifndef MOENIS_ENABLE_STATS
+    std::cerr << "Moenis: --stats is unavailable, built without ENABLE_STATS\n";
+    return 1;
+#else
+    std::ofstream out(stats_path);
+    moenis::stats::write_json(out, moenis::stats::merge());
+    out.close();
+    if (!out) {
+      std::cerr << "Moenis: failed to write stats to '" << stats_path << "'\n";
+      return 1;
+    }
+#endif
+  }
+  return 0;
+}
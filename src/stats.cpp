@@ -0,0 +1,139 @@
+#include "stats.hpp"
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "version.hpp"
+
+#define MOENIS_STRINGIFY_(x) #x
+#define MOENIS_STRINGIFY(x) MOENIS_STRINGIFY_(x)
+
+namespace moenis {
+namespace stats {
+
+namespace {
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadStats>> blocks;
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+}  // namespace
+
+const char* name(Counter counter) {
+  switch (counter) {
+    case Counter::CAMERA_RAYS:
+      return "camera_rays";
+    case Counter::SHADOW_RAYS:
+      return "shadow_rays";
+    case Counter::INDIRECT_RAYS:
+      return "indirect_rays";
+    case Counter::BVH_NODES_VISITED:
+      return "bvh_nodes_visited";
+    case Counter::TRIANGLE_TESTS:
+      return "triangle_tests";
+    case Counter::SHADING_CALLS:
+      return "shading_calls";
+    case Counter::SAMPLES:
+      return "samples";
+    case Counter::PIXELS:
+      return "pixels";
+    case Counter::ALLOCATED_BYTES:
+      return "allocated_bytes";
+    case Counter::COUNT:
+      break;
+  }
+  return "unknown";
+}
+
+const char* name(Phase phase) {
+  switch (phase) {
+    case Phase::SCENE_LOAD:
+      return "scene_load";
+    case Phase::BVH_BUILD:
+      return "bvh_build";
+    case Phase::RENDER:
+      return "render";
+    case Phase::OUTPUT:
+      return "output";
+    case Phase::COUNT:
+      break;
+  }
+  return "unknown";
+}
+
+ThreadStats& local() {
+  thread_local ThreadStats* block = nullptr;
+  if (block == nullptr) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.blocks.push_back(std::make_unique<ThreadStats>());
+    block = reg.blocks.back().get();
+  }
+  return *block;
+}
+
+Report merge() {
+  Report report;
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (const std::unique_ptr<ThreadStats>& block : reg.blocks) {
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+      report.counters[i] += block->counters[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < PHASE_COUNT; ++i) {
+      report.phase_ns[i] += block->phase_ns[i].load(std::memory_order_relaxed);
+    }
+  }
+  return report;
+}
+
+void write_json(std::ostream& out, const Report& report) {
+#ifdef MOENIS_ENABLE_STATS
+  constexpr bool enabled = true;
+#else
+  constexpr bool enabled = false;
+#endif
+  out << "{\n";
+  out << "  \"version\": {\n";
+  out << "    \"major\": " << VERSION_MAJOR << ",\n";
+  out << "    \"minor\": " << VERSION_MINOR << ",\n";
+  out << "    \"patch\": " << VERSION_PATCH << ",\n";
+  out << "    \"commit\": \"" << MOENIS_STRINGIFY(VERSION_COMMIT) << "\"\n";
+  out << "  },\n";
+  out << "  \"stats_enabled\": " << (enabled ? "true" : "false") << ",\n";
+  out << "  \"counters\": {\n";
+  for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+    out << "    \"" << name(static_cast<Counter>(i))
+        << "\": " << report.counters[i]
+        << (i + 1 < COUNTER_COUNT ? ",\n" : "\n");
+  }
+  out << "  },\n";
+  out << "  \"phases_ns\": {\n";
+  for (std::size_t i = 0; i < PHASE_COUNT; ++i) {
+    out << "    \"" << name(static_cast<Phase>(i))
+        << "\": " << report.phase_ns[i]
+        << (i + 1 < PHASE_COUNT ? ",\n" : "\n");
+  }
+  out << "  },\n";
+  const std::uint64_t pixels = report[Counter::PIXELS];
+  const double spp =
+      pixels == 0 ? 0.0
+                  : static_cast<double>(report[Counter::SAMPLES]) /
+                        static_cast<double>(pixels);
+  const std::streamsize precision =
+      out.precision(std::numeric_limits<double>::max_digits10);
+  out << "  \"derived\": {\n";
+  out << "    \"samples_per_pixel\": " << spp << "\n";
+  out << "  }\n";
+  out.precision(precision);
+  out << "}\n";
+}
+
+}  // namespace stats
+}  // namespace moenis
@@ -0,0 +1,91 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr unsigned THREADS = 8;
+constexpr std::uint64_t INCREMENTS = 1000000;
+constexpr std::uint64_t WORK = 50000000;
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << "\n";
+    ++failures;
+  }
+}
+
+// Stand-in for per-sample render work; the counted variant bumps a counter
+// each iteration, which is far denser than any real traversal would.
+template <bool COUNTED>
+std::uint64_t hot_loop(std::uint64_t seed) {
+  std::uint64_t x = seed;
+  for (std::uint64_t i = 0; i < WORK; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    if (COUNTED) {
+      moenis::stats::add(moenis::stats::Counter::TRIANGLE_TESTS);
+    }
+  }
+  return x;
+}
+
+template <bool COUNTED>
+double time_hot_loop(std::uint64_t* sink) {
+  auto start = std::chrono::steady_clock::now();
+  *sink += hot_loop<COUNTED>(*sink | 1);
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+}  // namespace
+
+int main() {
+  using moenis::stats::Counter;
+  using moenis::stats::Phase;
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < THREADS; ++t) {
+    workers.emplace_back([] {
+      moenis::stats::ScopedPhase phase(Phase::RENDER);
+      for (std::uint64_t i = 0; i < INCREMENTS; ++i) {
+        moenis::stats::add(Counter::CAMERA_RAYS);
+      }
+      moenis::stats::add(Counter::ALLOCATED_BYTES, 64);
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Counts must survive the threads that produced them.
+  moenis::stats::Report report = moenis::stats::merge();
+  check(report[Counter::CAMERA_RAYS] == THREADS * INCREMENTS,
+        "camera_rays == THREADS * INCREMENTS");
+  check(report[Counter::ALLOCATED_BYTES] == THREADS * 64,
+        "allocated_bytes == THREADS * 64");
+  check(report[Counter::SHADOW_RAYS] == 0, "untouched counter stays zero");
+  check(report[Phase::RENDER] > 0, "render phase recorded");
+
+  std::uint64_t sink = 0x9e3779b97f4a7c15ULL;
+  double plain = time_hot_loop<false>(&sink);
+  double counted = time_hot_loop<true>(&sink);
+  plain = std::min(plain, time_hot_loop<false>(&sink));
+  counted = std::min(counted, time_hot_loop<true>(&sink));
+  check(moenis::stats::merge()[Counter::TRIANGLE_TESTS] == 2 * WORK,
+        "triangle_tests == 2 * WORK");
+
+  std::cout << "stats off: " << plain << "s\n"
+            << "stats on:  " << counted << "s\n"
+            << "overhead:  " << 100.0 * (counted - plain) / plain
+            << "% for one increment per iteration (sink " << sink % 2
+            << ")\n";
+  return failures == 0 ? 0 : 1;
+}